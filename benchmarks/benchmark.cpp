@@ -5,11 +5,13 @@
 #include <fstream>
 #include <queue>
 #include <climits>
+#include "daemon.h"
 
 // Прототипы функций
 void measureReadThroughput(const char* filename, size_t iterations);
 void findShortestPath(const std::vector<std::vector<std::pair<int, int>>>& graph);
 std::vector<std::vector<std::pair<int, int>>> createVeryComplexGraph(int nodes, int edgesPerNode, int maxWeight);
+void measureDynamicShortestPath(size_t updates);
 
 int main(int argc, char* argv[]) {
     if (argc < 3) {
@@ -17,10 +19,23 @@ int main(int argc, char* argv[]) {
         std::cerr << "Available benchmarks:" << std::endl;
         std::cerr << "  io-thpt-read <file> <iterations>    - Measure disk read throughput" << std::endl;
         std::cerr << "  short-path <iterations>             - Find shortest path in predefined graph" << std::endl;
+        std::cerr << "  dyn-short-path <updates>            - Incremental shortest paths vs full recomputation" << std::endl;
+        std::cerr << "  daemon <socket> <short-path-rate> <read-rate> [file] [window]" << std::endl;
+        std::cerr << "                                      - Open-loop soak test, Prometheus metrics on a Unix socket" << std::endl;
         return 1;
     }
 
     std::string benchmark = argv[1];
+
+    // Долгоживущий режим: частоты вместо числа итераций
+    if (benchmark == "daemon") {
+        DaemonOptions options;
+        if (!parseDaemonOptions(argc, argv, options)) {
+            return 1;
+        }
+        return runBenchmarkDaemon(options);
+    }
+
     int iterations = 0;
     const char* filename = nullptr;
 
@@ -32,6 +47,13 @@ int main(int argc, char* argv[]) {
             }
             iterations = std::stoi(argv[2]);
         }
+        else if (benchmark == "dyn-short-path") {
+            if (argc != 3) {
+                std::cerr << "Usage: " << argv[0] << " dyn-short-path <updates>" << std::endl;
+                return 1;
+            }
+            iterations = std::stoi(argv[2]);
+        }
         else if (benchmark == "io-thpt-read") {
             if (argc != 4) {
                 std::cerr << "Usage: " << argv[0] << " io-thpt-read <file> <iterations>" << std::endl;
@@ -67,6 +89,8 @@ int main(int argc, char* argv[]) {
             std::chrono::duration<double> elapsed = endTime - startTime;
             std::cout << "Iteration " << i + 1 << " completed in " << elapsed.count() << " seconds" << std::endl;
         }
+    } else if (benchmark == "dyn-short-path") {
+        measureDynamicShortestPath(iterations);
     }
 
     return 0;
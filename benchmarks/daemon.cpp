@@ -0,0 +1,482 @@
+#include "daemon.h"
+#include "dynamic_short_path.h"
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+std::vector<std::vector<std::pair<int, int>>> createVeryComplexGraph(int nodes, int edgesPerNode, int maxWeight);
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const size_t maxSamples = 1 << 20; // Ограничение памяти под окно перцентилей
+
+// Допустимые значения аргументов. Нижняя граница частоты держит интервал
+// между операциями в пределах, где duration_cast не переполняется.
+const double minRate = 0.01;
+const double maxRate = 1e6;
+const double minWindowSeconds = 1;
+const double maxWindowSeconds = 24 * 60 * 60;
+
+std::atomic<bool> stopRequested(false);
+
+void handleStopSignal(int) {
+    stopRequested = true;
+}
+
+// Счётчики и скользящее окно задержек одной нагрузки
+class WorkloadStats {
+public:
+    WorkloadStats(const std::string& name, double targetRate, double windowSeconds)
+        : name(name), targetRate(targetRate),
+          window(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(windowSeconds))) {}
+
+    void record(Clock::time_point finishedAt, double latency, bool ok) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!ok) {
+            ++errors;
+            return;
+        }
+        ++ops;
+        latencySum += latency;
+        samples.emplace_back(finishedAt, latency);
+        if (samples.size() > maxSamples) {
+            samples.pop_front();
+        }
+
+        // Пропускную способность считаем по секундным корзинам: в отличие от
+        // samples, они не ограничены maxSamples и не теряют операции
+        auto second = std::chrono::duration_cast<std::chrono::seconds>(finishedAt.time_since_epoch()).count();
+        if (buckets.empty() || buckets.back().first != second) {
+            buckets.emplace_back(second, 0);
+        }
+        ++buckets.back().second;
+        pruneBuckets(finishedAt);
+    }
+
+    struct Snapshot {
+        uint64_t ops = 0;
+        uint64_t errors = 0;
+        double latencySum = 0;
+        double throughput = 0;
+        std::vector<double> window; // Задержки за окно
+    };
+
+    Snapshot snapshot(Clock::time_point now, Clock::time_point startedAt) {
+        Snapshot s;
+        std::lock_guard<std::mutex> lock(mutex);
+
+        while (!samples.empty() && samples.front().first < now - window) {
+            samples.pop_front();
+        }
+        pruneBuckets(now);
+
+        s.ops = ops;
+        s.errors = errors;
+        s.latencySum = latencySum;
+        s.window.reserve(samples.size());
+        for (const auto& sample : samples) {
+            s.window.push_back(sample.second);
+        }
+
+        // Окно начинается с границы самой старой корзины; в начале работы
+        // оно ещё не заполнено, поэтому делим на фактическое время
+        uint64_t completed = 0;
+        for (const auto& bucket : buckets) {
+            completed += bucket.second;
+        }
+        auto windowBegin = startedAt;
+        if (!buckets.empty()) {
+            windowBegin = std::max(startedAt, Clock::time_point(std::chrono::seconds(buckets.front().first)));
+        }
+        double elapsed = std::chrono::duration<double>(now - windowBegin).count();
+        if (elapsed > 0) {
+            s.throughput = completed / elapsed;
+        }
+        return s;
+    }
+
+    // Запланированное время операции, которую рабочий поток выполняет или ждёт.
+    // Публикуется без блокировки, чтобы зависшая операция была видна при опросе.
+    void setScheduled(Clock::time_point scheduled) {
+        nextScheduled.store(scheduled.time_since_epoch().count(), std::memory_order_relaxed);
+    }
+
+    // Насколько поток отстаёт от расписания прямо сейчас
+    double scheduleLag(Clock::time_point now) const {
+        Clock::time_point scheduled{Clock::duration(nextScheduled.load(std::memory_order_relaxed))};
+        return std::max(0.0, std::chrono::duration<double>(now - scheduled).count());
+    }
+
+    const std::string name;
+    const double targetRate;
+
+private:
+    // Оставляем корзины, хотя бы частично попадающие в окно
+    void pruneBuckets(Clock::time_point now) {
+        auto oldest = std::chrono::duration_cast<std::chrono::seconds>((now - window).time_since_epoch()).count();
+        while (!buckets.empty() && buckets.front().first < oldest) {
+            buckets.pop_front();
+        }
+    }
+
+    const Clock::duration window;
+    std::mutex mutex;
+    uint64_t ops = 0;
+    uint64_t errors = 0;
+    double latencySum = 0;
+    std::atomic<Clock::rep> nextScheduled{Clock::duration::max().count()}; // До старта потока отставания нет
+    std::deque<std::pair<Clock::time_point, double>> samples; // {время завершения, задержка}
+    std::deque<std::pair<int64_t, uint64_t>> buckets;          // {секунда, завершённых операций}
+};
+
+// Open-loop: операции запускаются по расписанию start + i * interval, а задержка
+// отсчитывается от запланированного момента. Если операция затянулась, следующие
+// не сдвигаются, поэтому очередь ожидания попадает в перцентили (нет coordinated omission).
+void runOpenLoop(WorkloadStats& stats, const std::function<bool()>& op) {
+    auto interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / stats.targetRate));
+    auto start = Clock::now();
+
+    for (uint64_t i = 0; !stopRequested; ++i) {
+        auto scheduled = start + interval * static_cast<Clock::rep>(i);
+        stats.setScheduled(scheduled);
+        // Спим короткими отрезками, чтобы быстро реагировать на остановку
+        while (!stopRequested && Clock::now() < scheduled) {
+            std::this_thread::sleep_until(std::min(scheduled, Clock::now() + std::chrono::milliseconds(100)));
+        }
+        if (stopRequested) break;
+
+        bool ok = op();
+        auto finished = Clock::now();
+
+        double latency = std::chrono::duration<double>(finished - scheduled).count();
+        stats.record(finished, latency, ok);
+    }
+}
+
+double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) return 0;
+    size_t index = static_cast<size_t>(q * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+// Текстовый формат Prometheus: все сэмплы одной метрики идут подряд
+std::string renderMetrics(std::vector<WorkloadStats*>& workloads, Clock::time_point startedAt) {
+    auto now = Clock::now();
+    std::vector<WorkloadStats::Snapshot> snapshots;
+    for (auto* w : workloads) {
+        snapshots.push_back(w->snapshot(now, startedAt));
+        // Сортируем вне блокировки, чтобы не задерживать рабочие потоки
+        std::sort(snapshots.back().window.begin(), snapshots.back().window.end());
+    }
+
+    std::ostringstream out;
+    // Счётчики и суммы растут часами, 6 значащих цифр по умолчанию их огрубляют
+    out << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+    // Одна строка сэмпла: name{labels} value
+    auto sample = [&](const std::string& name, const std::string& labels, auto value) {
+        out << name;
+        if (!labels.empty()) {
+            out << "{" << labels << "}";
+        }
+        out << " " << value << "\n";
+    };
+
+    // Заголовок метрики и по сэмплу на каждую нагрузку; emit получает готовый набор меток
+    auto family = [&](const char* name, const char* type, const char* help,
+                      const std::function<void(const std::string&, size_t)>& emit) {
+        out << "# HELP " << name << " " << help << "\n";
+        out << "# TYPE " << name << " " << type << "\n";
+        for (size_t i = 0; i < workloads.size(); ++i) {
+            emit("workload=\"" + workloads[i]->name + "\"", i);
+        }
+    };
+
+    family("oslab_bench_ops_total", "counter", "Completed operations.",
+           [&](const std::string& labels, size_t i) {
+               sample("oslab_bench_ops_total", labels, snapshots[i].ops);
+           });
+    family("oslab_bench_errors_total", "counter", "Failed operations.",
+           [&](const std::string& labels, size_t i) {
+               sample("oslab_bench_errors_total", labels, snapshots[i].errors);
+           });
+    family("oslab_bench_latency_seconds", "summary", "Latency from scheduled start, quantiles over the rolling window.",
+           [&](const std::string& labels, size_t i) {
+               const std::pair<const char*, double> quantiles[] = {{"0.5", 0.5}, {"0.9", 0.9}, {"0.99", 0.99}, {"0.999", 0.999}};
+               for (const auto& [label, q] : quantiles) {
+                   sample("oslab_bench_latency_seconds", labels + ",quantile=\"" + label + "\"",
+                          percentile(snapshots[i].window, q));
+               }
+               sample("oslab_bench_latency_seconds_sum", labels, snapshots[i].latencySum);
+               sample("oslab_bench_latency_seconds_count", labels, snapshots[i].ops);
+           });
+    family("oslab_bench_throughput_ops_per_second", "gauge", "Completed operations per second over the rolling window.",
+           [&](const std::string& labels, size_t i) {
+               sample("oslab_bench_throughput_ops_per_second", labels, snapshots[i].throughput);
+           });
+    family("oslab_bench_target_rate_ops_per_second", "gauge", "Configured open-loop arrival rate.",
+           [&](const std::string& labels, size_t i) {
+               sample("oslab_bench_target_rate_ops_per_second", labels, workloads[i]->targetRate);
+           });
+    family("oslab_bench_schedule_lag_seconds", "gauge", "How far the worker is behind its open-loop schedule, including an operation still running.",
+           [&](const std::string& labels, size_t i) {
+               sample("oslab_bench_schedule_lag_seconds", labels, workloads[i]->scheduleLag(now));
+           });
+
+    out << "# HELP oslab_bench_uptime_seconds Time since the daemon started.\n";
+    out << "# TYPE oslab_bench_uptime_seconds gauge\n";
+    sample("oslab_bench_uptime_seconds", "", std::chrono::duration<double>(now - startedAt).count());
+    return out.str();
+}
+
+void sendAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return;
+        sent += n;
+    }
+}
+
+// Отвечает одному клиенту. HTTP-запрос (curl --unix-socket) получает HTTP-ответ,
+// любой другой клиент (например, nc -U) - просто текст метрик.
+void serveClient(int clientFd, const std::string& body) {
+    char request[4096];
+    ssize_t n = 0;
+    pollfd pfd = {clientFd, POLLIN, 0};
+    if (poll(&pfd, 1, 100) > 0) {
+        n = recv(clientFd, request, sizeof(request), 0);
+    }
+
+    if (n >= 4 && std::strncmp(request, "GET ", 4) == 0) {
+        std::ostringstream response;
+        response << "HTTP/1.0 200 OK\r\n"
+                 << "Content-Type: text/plain; version=0.0.4\r\n"
+                 << "Content-Length: " << body.size() << "\r\n\r\n"
+                 << body;
+        sendAll(clientFd, response.str());
+    } else {
+        sendAll(clientFd, body);
+    }
+}
+
+// Строгий разбор числа: вся строка, конечное значение
+bool parseNumber(const char* text, double& value) {
+    try {
+        size_t pos = 0;
+        value = std::stod(text, &pos);
+        return text[pos] == '\0' && std::isfinite(value);
+    } catch (const std::invalid_argument& e) {
+        return false;
+    } catch (const std::out_of_range& e) {
+        return false;
+    }
+}
+
+// Удаляет оставшийся от прошлого запуска сокет. Обычные файлы не трогаем,
+// а живой сокет означает, что другой демон уже слушает этот путь.
+bool removeStaleSocket(const std::string& path, const sockaddr_un& addr) {
+    struct stat st;
+    if (lstat(path.c_str(), &st) == -1) {
+        if (errno == ENOENT) return true;
+        std::cerr << "Error: cannot stat " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (!S_ISSOCK(st.st_mode)) {
+        std::cerr << "Error: " << path << " exists and is not a socket" << std::endl;
+        return false;
+    }
+
+    int probeFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (probeFd == -1) {
+        std::cerr << "Error: failed to create socket" << std::endl;
+        return false;
+    }
+    bool alive = connect(probeFd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) == 0;
+    close(probeFd);
+
+    if (alive) {
+        std::cerr << "Error: another daemon is already running on " << path << std::endl;
+        return false;
+    }
+    if (unlink(path.c_str()) == -1 && errno != ENOENT) {
+        std::cerr << "Error: cannot remove stale socket " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+bool parseDaemonOptions(int argc, char* argv[], DaemonOptions& options) {
+    if (argc < 5 || argc > 7) {
+        std::cerr << "Usage: " << argv[0] << " daemon <socket> <short-path-rate> <read-rate> [file] [window]" << std::endl;
+        return false;
+    }
+
+    options.socketPath = argv[2];
+    if (!parseNumber(argv[3], options.shortPathRate) || !parseNumber(argv[4], options.readRate)) {
+        std::cerr << "Error: Invalid rate" << std::endl;
+        return false;
+    }
+    if (argc == 7 && !parseNumber(argv[6], options.windowSeconds)) {
+        std::cerr << "Error: Invalid window" << std::endl;
+        return false;
+    }
+
+    // 0 отключает нагрузку, иначе частота должна быть в допустимых пределах
+    for (double rate : {options.shortPathRate, options.readRate}) {
+        if (rate != 0 && (rate < minRate || rate > maxRate)) {
+            std::cerr << "Error: Rates must be 0 or between " << minRate << " and " << maxRate << " ops/s!" << std::endl;
+            return false;
+        }
+    }
+    if (options.shortPathRate == 0 && options.readRate == 0) {
+        std::cerr << "Error: At least one workload rate must be positive!" << std::endl;
+        return false;
+    }
+    if (options.windowSeconds < minWindowSeconds || options.windowSeconds > maxWindowSeconds) {
+        std::cerr << "Error: Window must be between " << minWindowSeconds << " and " << maxWindowSeconds << " seconds!" << std::endl;
+        return false;
+    }
+
+    if (options.readRate > 0) {
+        if (argc < 6) {
+            std::cerr << "Error: read workload requires a file" << std::endl;
+            return false;
+        }
+        options.readFile = argv[5];
+    }
+    return true;
+}
+
+int runBenchmarkDaemon(const DaemonOptions& options) {
+    sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (options.socketPath.size() >= sizeof(addr.sun_path)) {
+        std::cerr << "Error: Socket path is too long: " << options.socketPath << std::endl;
+        return 1;
+    }
+    std::strncpy(addr.sun_path, options.socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    // Нагрузка чтения: блоки по 8K последовательно по кругу
+    const size_t blockSize = 8 * 1024;
+    int readFd = -1;
+    off_t readLimit = 0;
+    if (options.readRate > 0) {
+        readFd = open(options.readFile.c_str(), O_RDONLY);
+        if (readFd == -1) {
+            std::cerr << "Error opening file: " << options.readFile << std::endl;
+            return 1;
+        }
+        off_t fileSize = lseek(readFd, 0, SEEK_END);
+        readLimit = fileSize - fileSize % blockSize;
+        if (readLimit <= 0) {
+            std::cerr << "File is too small to read a single block." << std::endl;
+            close(readFd);
+            return 1;
+        }
+    }
+
+    int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd == -1) {
+        std::cerr << "Error: failed to create socket" << std::endl;
+        if (readFd != -1) close(readFd);
+        return 1;
+    }
+    if (!removeStaleSocket(options.socketPath, addr)) {
+        close(listenFd);
+        if (readFd != -1) close(readFd);
+        return 1;
+    }
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == -1 || listen(listenFd, 16) == -1) {
+        if (errno == EADDRINUSE) {
+            std::cerr << "Error: another daemon is already running on " << options.socketPath << std::endl;
+        } else {
+            std::cerr << "Error: failed to listen on " << options.socketPath << ": " << std::strerror(errno) << std::endl;
+        }
+        close(listenFd);
+        if (readFd != -1) close(readFd);
+        return 1;
+    }
+
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+
+    WorkloadStats shortPathStats("short_path", options.shortPathRate, options.windowSeconds);
+    WorkloadStats readStats("io_thpt_read", options.readRate, options.windowSeconds);
+    std::vector<WorkloadStats*> workloads;
+    std::vector<std::thread> workers;
+    auto startedAt = Clock::now();
+
+    if (options.shortPathRate > 0) {
+        workloads.push_back(&shortPathStats);
+        workers.emplace_back([&shortPathStats]() {
+            DynamicShortestPath dsp(createVeryComplexGraph(10000, 10, 100), 0);
+            runOpenLoop(shortPathStats, [&dsp]() {
+                dsp.recompute();
+                return true;
+            });
+        });
+    }
+
+    if (options.readRate > 0) {
+        workloads.push_back(&readStats);
+        workers.emplace_back([&readStats, readFd, readLimit, blockSize]() {
+            std::vector<char> buffer(blockSize);
+            off_t offset = 0;
+            runOpenLoop(readStats, [&]() {
+                ssize_t n = pread(readFd, buffer.data(), blockSize, offset);
+                offset = (offset + blockSize) % readLimit;
+                return n == static_cast<ssize_t>(blockSize);
+            });
+        });
+    }
+
+    std::cout << "Serving metrics on " << options.socketPath << " (Ctrl+C to stop)" << std::endl;
+
+    while (!stopRequested) {
+        pollfd pfd = {listenFd, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0) continue;
+
+        int clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd == -1) continue;
+        serveClient(clientFd, renderMetrics(workloads, startedAt));
+        close(clientFd);
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    close(listenFd);
+    unlink(options.socketPath.c_str());
+    if (readFd != -1) close(readFd);
+
+    std::cout << "Daemon stopped." << std::endl;
+    return 0;
+}
@@ -0,0 +1,23 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <string>
+
+// Параметры долгоживущего режима бенчмарка
+struct DaemonOptions {
+    std::string socketPath;    // Путь к Unix-сокету для метрик
+    double shortPathRate = 0;  // Целевая частота short-path, операций/с (0 - отключено)
+    double readRate = 0;       // Целевая частота io-thpt-read, операций/с (0 - отключено)
+    std::string readFile;      // Файл для нагрузки чтения
+    double windowSeconds = 60; // Окно скользящих перцентилей, секунды
+};
+
+// Разбирает и проверяет аргументы "daemon <socket> <short-path-rate> <read-rate> [file] [window]".
+// При ошибке печатает сообщение и возвращает false.
+bool parseDaemonOptions(int argc, char* argv[], DaemonOptions& options);
+
+// Запускает нагрузку с фиксированной частотой (open-loop) и отдаёт метрики
+// в текстовом формате Prometheus через Unix-сокет. Работает до SIGINT/SIGTERM.
+int runBenchmarkDaemon(const DaemonOptions& options);
+
+#endif // DAEMON_H
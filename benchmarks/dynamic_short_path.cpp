@@ -0,0 +1,164 @@
+#include "dynamic_short_path.h"
+#include <iostream>
+#include <chrono>
+#include <queue>
+#include <cstdlib>
+#include <limits>
+#include <functional>
+
+std::vector<std::vector<std::pair<int, int>>> createVeryComplexGraph(int nodes, int edgesPerNode, int maxWeight);
+
+namespace {
+const int INF = std::numeric_limits<int>::max();
+using Node = std::pair<int, int>; // {расстояние, вершина}
+}
+
+DynamicShortestPath::DynamicShortestPath(const Graph& graph, int source)
+    : graph(graph), source(source) {
+    recompute();
+}
+
+void DynamicShortestPath::recompute() {
+    distances.assign(graph.size(), INF);
+    parents.assign(graph.size(), -1);
+    distances[source] = 0;
+
+    std::priority_queue<Node, std::vector<Node>, std::greater<>> pq;
+    pq.push({0, source});
+
+    while (!pq.empty()) {
+        auto [currentDistance, currentVertex] = pq.top();
+        pq.pop();
+
+        if (currentDistance > distances[currentVertex]) continue;
+
+        for (const auto& [neighbor, weight] : graph[currentVertex]) {
+            int newDistance = currentDistance + weight;
+            if (newDistance < distances[neighbor]) {
+                distances[neighbor] = newDistance;
+                parents[neighbor] = currentVertex;
+                pq.push({newDistance, neighbor});
+            }
+        }
+    }
+}
+
+size_t DynamicShortestPath::addEdge(int u, int v, int w) {
+    graph[u].emplace_back(v, w);
+    return relaxFrom(u, v, w);
+}
+
+size_t DynamicShortestPath::decreaseWeight(int u, int v, int w) {
+    for (auto& [neighbor, weight] : graph[u]) {
+        if (neighbor == v && w < weight) {
+            weight = w;
+            return relaxFrom(u, v, w);
+        }
+    }
+    return 0;
+}
+
+size_t DynamicShortestPath::relaxFrom(int u, int v, int w) {
+    // Ребро может улучшить путь только если u достижима и путь через него короче
+    if (distances[u] == INF || distances[u] + w >= distances[v]) {
+        return 0;
+    }
+
+    distances[v] = distances[u] + w;
+    parents[v] = u;
+
+    // Дейкстра, стартующая только с v: очередь содержит лишь вершины,
+    // расстояние до которых уменьшилось, поэтому остальной граф не трогается.
+    std::priority_queue<Node, std::vector<Node>, std::greater<>> pq;
+    pq.push({distances[v], v});
+    size_t updated = 1;
+
+    while (!pq.empty()) {
+        auto [currentDistance, currentVertex] = pq.top();
+        pq.pop();
+
+        if (currentDistance > distances[currentVertex]) continue;
+
+        for (const auto& [neighbor, weight] : graph[currentVertex]) {
+            int newDistance = currentDistance + weight;
+            if (newDistance < distances[neighbor]) {
+                ++updated;
+                distances[neighbor] = newDistance;
+                parents[neighbor] = currentVertex;
+                pq.push({newDistance, neighbor});
+            }
+        }
+    }
+
+    return updated;
+}
+
+// Поток случайных обновлений (новые рёбра и уменьшение весов):
+// сравниваем время инкрементального обновления с полным пересчётом
+void measureDynamicShortestPath(size_t updates) {
+    const int nodes = 10000;
+    const int maxWeight = 100;
+    const size_t recomputeEvery = 100; // Полный пересчёт дорогой, меряем его выборочно
+
+    DynamicShortestPath dsp(createVeryComplexGraph(nodes, 10, maxWeight), 0);
+    DynamicShortestPath reference = dsp;
+
+    double incrementalTotal = 0.0;
+    double recomputeTotal = 0.0;
+    size_t recomputeCount = 0;
+    size_t touchedTotal = 0;
+
+    for (size_t i = 0; i < updates; ++i) {
+        int u = std::rand() % nodes;
+        int v = std::rand() % nodes;
+        int w = 1 + std::rand() % maxWeight;
+        bool insert = std::rand() % 2 == 0 || dsp.getGraph()[u].empty();
+        if (!insert) {
+            // Уменьшаем вес случайного существующего ребра
+            const auto& edges = dsp.getGraph()[u];
+            auto [neighbor, weight] = edges[std::rand() % edges.size()];
+            v = neighbor;
+            w = 1 + std::rand() % weight;
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+        size_t touched = insert ? dsp.addEdge(u, v, w) : dsp.decreaseWeight(u, v, w);
+        auto endTime = std::chrono::high_resolution_clock::now();
+
+        if (insert) {
+            reference.addEdge(u, v, w);
+        } else {
+            reference.decreaseWeight(u, v, w);
+        }
+
+        std::chrono::duration<double> elapsed = endTime - startTime;
+        incrementalTotal += elapsed.count();
+        touchedTotal += touched;
+
+        if ((i + 1) % recomputeEvery == 0 || i + 1 == updates) {
+            startTime = std::chrono::high_resolution_clock::now();
+            reference.recompute();
+            endTime = std::chrono::high_resolution_clock::now();
+
+            elapsed = endTime - startTime;
+            recomputeTotal += elapsed.count();
+            ++recomputeCount;
+
+            if (reference.getDistances() != dsp.getDistances()) {
+                std::cerr << "Error: incremental distances diverged after update " << i + 1 << std::endl;
+                return;
+            }
+        }
+    }
+
+    double incrementalAvg = incrementalTotal / updates;
+    double recomputeAvg = recomputeTotal / recomputeCount;
+
+    std::cout << "Updates applied: " << updates << std::endl;
+    std::cout << "Average relaxations per update: " << static_cast<double>(touchedTotal) / updates << std::endl;
+    std::cout << "Incremental update: " << incrementalAvg * 1e6 << " us average" << std::endl;
+    std::cout << "Full recomputation: " << recomputeAvg * 1e6 << " us average" << std::endl;
+    if (incrementalAvg > 0) {
+        std::cout << "Speedup: " << recomputeAvg / incrementalAvg << "x" << std::endl;
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef DYNAMIC_SHORT_PATH_H
+#define DYNAMIC_SHORT_PATH_H
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+// Динамический граф с поддержкой дерева кратчайших путей (SSSP) от одного источника.
+// При добавлении ребра или уменьшении веса пересчитывается только затронутая область.
+class DynamicShortestPath
+{
+public:
+    using Graph = std::vector<std::vector<std::pair<int, int>>>; // {сосед, вес}
+
+    DynamicShortestPath(const Graph& graph, int source);
+
+    // Полный пересчёт алгоритмом Дейкстры (используется для сравнения)
+    void recompute();
+
+    // Добавляет ребро u -> v с весом w и чинит дерево путей.
+    // Возвращает количество успешных релаксаций (размер затронутой области).
+    size_t addEdge(int u, int v, int w);
+
+    // Уменьшает вес существующего ребра u -> v до w и чинит дерево путей.
+    // Если ребра нет или новый вес не меньше текущего, ничего не делает и возвращает 0.
+    size_t decreaseWeight(int u, int v, int w);
+
+    int distance(int v) const { return distances[v]; }
+    int parentOf(int v) const { return parents[v]; }
+    const std::vector<int>& getDistances() const { return distances; }
+    const Graph& getGraph() const { return graph; }
+
+private:
+    // Распространяет улучшение расстояния до v по графу
+    size_t relaxFrom(int u, int v, int w);
+
+    Graph graph;
+    int source;
+    std::vector<int> distances;
+    std::vector<int> parents;
+};
+
+#endif // DYNAMIC_SHORT_PATH_H